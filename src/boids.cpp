@@ -1,11 +1,31 @@
 #include "boids.h"
 
-Boids::Boids(const size_t population)
-    : population{ population }
-    , x(population), y(population)
-    , vx(population), vy(population)
-    , cohesionx(population), cohesiony(population)
-    , alignmentx(population), alignmenty(population)
-    , dangerx(population), dangery(population)
-    , turnx(population), turny(population)
-    , vertices(3 * population) {}
\ No newline at end of file
+Boids::Boids(const size_t population, const size_t capacity)
+    : capacity{ capacity }
+    , population{ population }
+    , x(capacity), y(capacity)
+    , vx(capacity), vy(capacity)
+    , cohesionx(capacity), cohesiony(capacity)
+    , alignmentx(capacity), alignmenty(capacity)
+    , dangerx(capacity), dangery(capacity)
+    , turnx(capacity), turny(capacity)
+    , vertices(3 * capacity)
+    , isDespawnQueued(capacity) {
+    despawnQueue.reserve(capacity);
+}
+
+size_t Boids::spawn(const float x, const float y, const float vx, const float vy) {
+    if (population == capacity) return capacity;
+    const auto index{ population++ };
+    this->x[index] = x;
+    this->y[index] = y;
+    this->vx[index] = vx;
+    this->vy[index] = vy;
+    return index;
+}
+
+void Boids::despawn(const size_t index) {
+    if (isDespawnQueued[index]) return;
+    isDespawnQueued[index] = true;
+    despawnQueue.push_back(index);
+}
\ No newline at end of file
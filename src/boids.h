@@ -1,14 +1,41 @@
 #ifndef BOIDS_BOIDS_H
 #define BOIDS_BOIDS_H
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 #include <SDL3/SDL.h>
 
 // Struct holding all the data related to boids.
+//
+// Storage for "capacity" boids is allocated once in the constructor,
+// spawning and despawning only move the "population" boundary and never reallocate.
+// Alive boids are always the ones with index in [0,"population").
 struct Boids {
-    explicit Boids(size_t population);
+    // "population" is the number of boids alive at the start,
+    // "capacity" is the maximum number of boids that can be alive at the same time.
+    Boids(size_t population, size_t capacity);
 
-    const size_t population;
+    // Add a boid at ("x","y") with velocity ("vx","vy").
+    //
+    // Return the index of the new boid, or "capacity" if there is no room left.
+    size_t spawn(float x, float y, float vx, float vy);
+    // Mark the boid of index "index" to be removed by the next "compact".
+    //
+    // Marking the same boid multiple times has no further effect.
+    //
+    // Using an index not in [0,"population") will result in undefined behavior.
+    void despawn(size_t index);
+
+    // Remove the boids marked by "despawn" by swapping them with the last alive boid.
+    //
+    // "onMove(from, to)" is called before boid "from" is moved to index "to".
+    // "onRemove(index)" is called before boid "index" is removed.
+    template<typename OnMove, typename OnRemove>
+    void compact(OnMove onMove, OnRemove onRemove);
+
+    const size_t capacity;
+    size_t population;
     std::vector<float> x;
     std::vector<float> y;
     std::vector<float> vx;
@@ -22,6 +49,35 @@ struct Boids {
     std::vector<float> turnx;
     std::vector<float> turny;
     std::vector<SDL_Vertex> vertices;
+
+private:
+    std::vector<size_t> despawnQueue;
+    std::vector<bool> isDespawnQueued;
 };
 
+
+
+
+
+template<typename OnMove, typename OnRemove>
+void Boids::compact(OnMove onMove, OnRemove onRemove) {
+    // Going from the highest index guarantees the last alive boid is never marked
+    std::ranges::sort(despawnQueue, std::greater{});
+    for (const auto index : despawnQueue) {
+        const auto last{ population - 1 };
+        onRemove(index);
+        if (index != last) {
+            onMove(last, index);
+            // Only the state survives across runs, the other arrays are recomputed every run
+            x[index] = x[last];
+            y[index] = y[last];
+            vx[index] = vx[last];
+            vy[index] = vy[last];
+        }
+        isDespawnQueued[index] = false;
+        population--;
+    }
+    despawnQueue.clear();
+}
+
 #endif //BOIDS_BOIDS_H
\ No newline at end of file
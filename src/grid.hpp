@@ -1,6 +1,7 @@
 #ifndef BOIDS_GRID_H
 #define BOIDS_GRID_H
 
+#include <algorithm>
 #include <vector>
 #include <cmath>
 #include <omp.h>
@@ -64,6 +65,13 @@ public:
     // Using invalid square "index" will result in undefined behavior.
     void remove(size_t index, size_t square);
 
+    // Replace "oldIndex" with "newIndex" in the square of index "square".
+    //
+    // Unlike a "remove" followed by an "add" it never reallocates the square.
+    //
+    // Using invalid square "index" will result in undefined behavior.
+    void replace(size_t oldIndex, size_t newIndex, size_t square);
+
     // Return the neighbors' indices of the point ("x","y").
     //
     // It assumes that the visibility range is half the size of a square.
@@ -78,6 +86,14 @@ public:
     [[nodiscard]]
     size_t coords2square(float x, float y) const;
 
+    // Return the number of squares.
+    [[nodiscard]]
+    size_t getSquaresNumber() const;
+
+    // Return the number of indices in the most crowded square.
+    [[nodiscard]]
+    size_t getMaxSquareOccupancy() const;
+
 private:
     // Check if "index" is a valid square index.
     [[nodiscard]]
@@ -150,6 +166,13 @@ void Grid<LockPolicy>::remove(const size_t index, const size_t square) {
     LockPolicy::releaseLock(square);
 }
 
+template<typename LockPolicy>
+void Grid<LockPolicy>::replace(const size_t oldIndex, const size_t newIndex, const size_t square) {
+    LockPolicy::acquireLock(square);
+    std::ranges::replace(grid[square], oldIndex, newIndex);
+    LockPolicy::releaseLock(square);
+}
+
 template<typename LockPolicy>
 std::vector<size_t> Grid<LockPolicy>::getNeighbors(const float x, const float y) const {
     const auto occupiedSquare{ coords2square(x, y) };
@@ -192,6 +215,20 @@ size_t Grid<LockPolicy>::coords2square(const float x, const float y) const {
     return static_cast<size_t>(x) / squareSize + (static_cast<size_t>(y) / squareSize) * squaresPerRow;
 }
 
+template<typename LockPolicy>
+size_t Grid<LockPolicy>::getSquaresNumber() const {
+    return squaresNumber;
+}
+
+template<typename LockPolicy>
+size_t Grid<LockPolicy>::getMaxSquareOccupancy() const {
+    size_t maxOccupancy{ 0 };
+    for (const auto& square : grid) {
+        maxOccupancy = std::max(maxOccupancy, square.size());
+    }
+    return maxOccupancy;
+}
+
 template<typename LockPolicy>
 bool Grid<LockPolicy>::isIndexValid(const size_t index) const {
     return index > -1 && index < squaresNumber;
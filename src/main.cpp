@@ -6,6 +6,7 @@
 #include "grid.hpp"
 #include "settings.h"
 #include "stats.h"
+#include "telemetry.h"
 
 // Initialize "boids" randomly and change "grid" accordingly.
 template<typename LockPolicy>
@@ -18,9 +19,10 @@ void randomizeBoids(Boids& boids, Grid<LockPolicy>& grid, const Settings& settin
         const float angle{ std::fmodf(static_cast<float>(generator()), 2 * std::numbers::pi) };
         boids.vx[i] = std::cos(angle) * settings.minVelocity;
         boids.vy[i] = std::sin(angle) * settings.minVelocity;
-        boids.vertices[3 * i].color = settings.boidsColor;
-        boids.vertices[3 * i + 1].color = settings.boidsColor;
-        boids.vertices[3 * i + 2].color = settings.boidsColor;
+    }
+    // Color the whole capacity so spawned boids never have to
+    for (auto& vertex : boids.vertices) {
+        vertex.color = settings.boidsColor;
     }
 }
 
@@ -34,9 +36,54 @@ float calculateNorm(const float x, const float y) {
     return std::sqrtf(x * x + y * y);
 }
 
+// Spawn "settings.spawnBurst" boids at ("x","y") with random directions and change "grid" accordingly.
+//
+// Stop spawning when "boids" capacity is reached.
+template<typename LockPolicy>
+void spawnBoids(Boids& boids, Grid<LockPolicy>& grid, const Settings& settings,
+                const float x, const float y, std::mt19937& generator) {
+    const auto spawnX{ std::clamp(x, 0.0f, static_cast<float>(settings.screenWidth) - .1f) };
+    const auto spawnY{ std::clamp(y, 0.0f, static_cast<float>(settings.screenHeight) - .1f) };
+    for (size_t i{ 0 }; i < settings.spawnBurst; i++) {
+        const float angle{ std::fmodf(static_cast<float>(generator()), 2 * std::numbers::pi) };
+        const auto index{ boids.spawn(spawnX, spawnY,
+            std::cos(angle) * settings.minVelocity, std::sin(angle) * settings.minVelocity) };
+        if (index == boids.capacity) break;
+        grid.add(index, spawnX, spawnY);
+    }
+}
+
+// Mark for despawning all the boids visible from ("x","y").
+template<typename LockPolicy>
+void despawnBoids(Boids& boids, const Grid<LockPolicy>& grid, const Settings& settings, const float x, const float y) {
+    const auto despawnX{ std::clamp(x, 0.0f, static_cast<float>(settings.screenWidth) - .1f) };
+    const auto despawnY{ std::clamp(y, 0.0f, static_cast<float>(settings.screenHeight) - .1f) };
+    for (const auto neighborIndex : grid.getNeighbors(despawnX, despawnY)) {
+        const auto squaredDistance{
+            calculateSquaredDistance(despawnX, despawnY, boids.x[neighborIndex], boids.y[neighborIndex])
+        };
+        if (squaredDistance <= settings.visibleRangeSquared) boids.despawn(neighborIndex);
+    }
+}
+
+// Remove the despawned "boids" and change "grid" accordingly in the same pass.
+template<typename LockPolicy>
+void compactBoids(Boids& boids, Grid<LockPolicy>& grid) {
+    boids.compact(
+        [&](const size_t from, const size_t to) {
+            grid.replace(from, to, grid.coords2square(boids.x[from], boids.y[from]));
+        },
+        [&](const size_t index) {
+            grid.remove(index, boids.x[index], boids.y[index]);
+        });
+}
+
 // Update "boids" velocities.
+//
+// If "neighborCandidates" is not null add to it the number of neighbors returned by "grid".
 template<typename LockPolicy>
-void updateBoidsVelocities(Boids& boids, const Grid<LockPolicy>& grid, const Settings& settings) {
+void updateBoidsVelocities(Boids& boids, const Grid<LockPolicy>& grid, const Settings& settings, size_t* neighborCandidates) {
+    size_t threadNeighborCandidates{ 0 };
 #pragma omp for schedule(dynamic, settings.neighborLoopChunkSize)
     for (int i{ 0 }; i < boids.population; i++) {
         size_t visibleBoidsNum{ 0 };
@@ -45,7 +92,9 @@ void updateBoidsVelocities(Boids& boids, const Grid<LockPolicy>& grid, const Set
         float averageVX { boids.vx[i] }, averageVY { boids.vy[i] };
 
         // Compute alignment, danger and cohesion velocity modifiers
-        for (const auto neighborIndex : grid.getNeighbors(boids.x[i], boids.y[i])) {
+        const auto neighbors{ grid.getNeighbors(boids.x[i], boids.y[i]) };
+        threadNeighborCandidates += neighbors.size();
+        for (const auto neighborIndex : neighbors) {
             if (neighborIndex == i) continue;
             const auto squaredDistance{
                 calculateSquaredDistance(boids.x[i], boids.y[i],
@@ -86,6 +135,10 @@ void updateBoidsVelocities(Boids& boids, const Grid<LockPolicy>& grid, const Set
         boids.turnx[i] = xTurnFactor;
         boids.turny[i] = yTurnFactor;
     }
+    if (neighborCandidates != nullptr) {
+#pragma omp atomic
+        *neighborCandidates += threadNeighborCandidates;
+    }
 #pragma omp for schedule(static)
     for (int i{ 0 }; i < boids.population; i++) {
         // Compute velocity
@@ -160,6 +213,33 @@ void updateBoidsVertices(Boids& boids, SDL_Renderer* renderer, const Settings& s
     }
 }
 
+// Return the number of simulation steps to run in a frame that started "frameDuration" after the previous one.
+//
+// Without a fixed step every frame runs a single step.
+// In throughput mode every frame runs "settings.maxStepsPerFrame" steps.
+// Otherwise "accumulatedTime" carries the time not yet simulated across frames,
+// and it is dropped when more than "settings.maxStepsPerFrame" steps would be needed.
+size_t calculateStepsNumber(const Settings& settings, const std::chrono::duration<float> frameDuration,
+                            std::chrono::duration<float>& accumulatedTime) {
+    if (settings.fixedStep == 0) return 1;
+    if (settings.throughputMode) return settings.maxStepsPerFrame;
+    accumulatedTime += frameDuration;
+    const auto stepsNumber{ static_cast<size_t>(accumulatedTime.count() / settings.fixedStep) };
+    if (stepsNumber > settings.maxStepsPerFrame) {
+        accumulatedTime = std::chrono::duration<float>::zero();
+        return settings.maxStepsPerFrame;
+    }
+    accumulatedTime -= static_cast<float>(stepsNumber) * std::chrono::duration<float>{ settings.fixedStep };
+    return stepsNumber;
+}
+
+// Add to "phaseTime" the microseconds elapsed since "phaseStartTick" and restart "phaseStartTick".
+void recordPhase(float& phaseTime, std::chrono::steady_clock::time_point& phaseStartTick) {
+    const auto now{ std::chrono::steady_clock::now() };
+    phaseTime += std::chrono::duration<float, std::micro>{ now - phaseStartTick }.count();
+    phaseStartTick = now;
+}
+
 int main(int argc, char* argv[]) {
     const auto settings{ loadSettings(argc > 1 ? argv[1] : "settings.txt") };
     Stats stats{ "log.txt" };
@@ -171,7 +251,7 @@ int main(int argc, char* argv[]) {
     SDL_SetRenderDrawColor(renderer, settings.clearRed, settings.clearGreen, settings.clearBlue, SDL_ALPHA_OPAQUE);
     bool isQuitRequested{ false };
 
-    Boids boids{ settings.population };
+    Boids boids{ settings.population, settings.capacity };
     const auto gridSquareSize{ static_cast<size_t>(ceilf(2.f * settings.visibleRange)) };
 #ifdef _OPENMP
     Grid<Lock> grid{ settings.screenWidth, settings.screenHeight, gridSquareSize };
@@ -179,18 +259,33 @@ int main(int argc, char* argv[]) {
     Grid grid{ settings.screenWidth, settings.screenHeight, gridSquareSize };
 #endif
     randomizeBoids(boids, grid, settings);
+    std::mt19937 generator{ std::random_device{}() };
+    TelemetryWriter telemetry{ settings.telemetryName };
+    const bool isTelemetryEnabled{ telemetry.isEnabled() };
 
     size_t runNumber{ 0 };
     auto lastFrameStartTick{ std::chrono::steady_clock::now() };
     decltype(lastFrameStartTick) currentFrameStartTick{};
+    size_t stepsNumber{ 0 };
+    std::chrono::duration<float> stepDuration{};
+    std::chrono::duration<float> accumulatedTime{};
+    TelemetrySample sample{};
+    decltype(lastFrameStartTick) phaseStartTick{};
+    size_t neighborCandidates{ 0 };
 #pragma omp parallel num_threads(settings.threadsNumber) default(none) \
-    shared(boids, grid, lastFrameStartTick, currentFrameStartTick, isQuitRequested, renderer, stats) \
-    firstprivate(settings, runNumber)
+    shared(boids, grid, generator, lastFrameStartTick, currentFrameStartTick, isQuitRequested, renderer, stats, \
+        stepsNumber, stepDuration, accumulatedTime, telemetry, sample, phaseStartTick, neighborCandidates) \
+    firstprivate(settings, runNumber, isTelemetryEnabled)
     while (!isQuitRequested && (settings.maxRunNumber == 0 || runNumber < settings.maxRunNumber)) {
         runNumber++;
 #pragma omp master
         {
             currentFrameStartTick = std::chrono::steady_clock::now();
+            if (isTelemetryEnabled) {
+                phaseStartTick = currentFrameStartTick;
+                sample = {};
+                neighborCandidates = 0;
+            }
             SDL_Event event;
             while (SDL_PollEvent(&event)) {
                 switch (event.type) {
@@ -202,25 +297,67 @@ int main(int argc, char* argv[]) {
                         isQuitRequested = true;
                         break;
                     }
+                    case SDL_EVENT_MOUSE_BUTTON_DOWN: {
+                        if (event.button.button == SDL_BUTTON_LEFT) {
+                            spawnBoids(boids, grid, settings, event.button.x, event.button.y, generator);
+                        } else if (event.button.button == SDL_BUTTON_RIGHT) {
+                            despawnBoids(boids, grid, settings, event.button.x, event.button.y);
+                        }
+                        break;
+                    }
                     default: {}
                 }
             }
+            compactBoids(boids, grid);
+
+            const std::chrono::duration<float> frameDuration{ currentFrameStartTick - lastFrameStartTick };
+            stepsNumber = calculateStepsNumber(settings, frameDuration, accumulatedTime);
+            stepDuration = settings.fixedStep == 0 ? frameDuration : std::chrono::duration<float>{ settings.fixedStep };
 
+            if (isTelemetryEnabled) recordPhase(sample.eventsTime, phaseStartTick);
             stats.startRun();
         }
 #pragma omp barrier
-        updateBoidsVelocities(boids, grid, settings);
-        updateBoidsPositions(boids, grid, settings, currentFrameStartTick - lastFrameStartTick);
+        // Copy the frame parameters, the master can overwrite them as soon as it leaves the last barrier
+        const auto frameStepsNumber{ stepsNumber };
+        const auto frameStepDuration{ stepDuration };
+        for (size_t step{ 0 }; step < frameStepsNumber; step++) {
+            updateBoidsVelocities(boids, grid, settings, isTelemetryEnabled ? &neighborCandidates : nullptr);
+            if (isTelemetryEnabled) {
+#pragma omp master
+                recordPhase(sample.velocitiesTime, phaseStartTick);
+            }
+            updateBoidsPositions(boids, grid, settings, frameStepDuration);
+            if (isTelemetryEnabled) {
+#pragma omp master
+                recordPhase(sample.positionsTime, phaseStartTick);
+            }
+        }
+#pragma omp barrier
 
 #pragma omp master
         {
-            stats.endRun();
+            stats.endRun(frameStepsNumber);
 
             updateBoidsVertices(boids, renderer, settings);
             SDL_RenderClear(renderer);
-            SDL_RenderGeometry(renderer, nullptr, boids.vertices.data(), static_cast<int>(3 * settings.population), nullptr, 0);
+            SDL_RenderGeometry(renderer, nullptr, boids.vertices.data(), static_cast<int>(3 * boids.population), nullptr, 0);
             SDL_RenderPresent(renderer);
             lastFrameStartTick = currentFrameStartTick;
+
+            if (isTelemetryEnabled) {
+                recordPhase(sample.renderTime, phaseStartTick);
+                sample.frame = runNumber;
+                sample.stepsNumber = frameStepsNumber;
+                sample.population = boids.population;
+                sample.frameTime =
+                    std::chrono::duration<float, std::micro>{ phaseStartTick - currentFrameStartTick }.count();
+                sample.maxSquareOccupancy = grid.getMaxSquareOccupancy();
+                sample.meanSquareOccupancy =
+                    static_cast<float>(boids.population) / static_cast<float>(grid.getSquaresNumber());
+                sample.neighborCandidates = neighborCandidates;
+                telemetry.publish(sample);
+            }
         }
     }
     stats.log();
@@ -23,6 +23,12 @@ Settings getSettings(const std::string& path) {
         if (word == "POPULATION") {
             in >> settings.population;
         }
+        else if (word == "CAPACITY") {
+            in >> settings.capacity;
+        }
+        else if (word == "SPAWN") {
+            in >> settings.spawnBurst;
+        }
         else if (word == "MAXRUN") {
             in >> settings.maxRunNumber;
         }
@@ -39,6 +45,12 @@ Settings getSettings(const std::string& path) {
         else if (word == "NOVSYNC") {
             settings.disableVSync = true;
         }
+        else if (word == "FIXEDSTEP") {
+            in >> settings.fixedStep >> settings.maxStepsPerFrame;
+        }
+        else if (word == "THROUGHPUT") {
+            settings.throughputMode = true;
+        }
         else if (word == "BOIDS") {
             in >> settings.boidsLength >> settings.boidsWidth;
             in >> settings.boidsColor.r >> settings.boidsColor.g >> settings.boidsColor.b;
@@ -66,6 +78,9 @@ Settings getSettings(const std::string& path) {
         else if (word == "TURN") {
             in >> settings.turnSpeed;
         }
+        else if (word == "TELEMETRY") {
+            in >> settings.telemetryName;
+        }
     }
     return settings;
 }
@@ -75,6 +90,16 @@ void checkSettings(const Settings& settings) {
         std::cerr << "Population should be at least 1, but was " << settings.population << std::endl;
         exit(-1);
     }
+    if (settings.capacity < settings.population) {
+        std::cerr << "Capacity should not be less than population." << std::endl;
+        std::cerr << "Capacity was " << settings.capacity << ", ";
+        std::cerr << "population was " << settings.population << std::endl;
+        exit(-1);
+    }
+    if (settings.spawnBurst < 1) {
+        std::cerr << "Spawn should be at least 1, but was " << settings.spawnBurst << std::endl;
+        exit(-1);
+    }
     if (settings.screenWidth < 600 || settings.screenHeight < 600) {
         std::cerr << "Window size should be at least (600,600)" << std::endl;
         std::cerr << "Window size was (" << settings.screenWidth << "," << settings.screenHeight << ")" << std::endl;
@@ -86,6 +111,18 @@ void checkSettings(const Settings& settings) {
         std::cerr << "min velocity was " << settings.minVelocity << std::endl;
         exit(-1);
     }
+    if (settings.fixedStep < 0) {
+        std::cerr << "Fixed step should be at least 0, but was " << settings.fixedStep << std::endl;
+        exit(-1);
+    }
+    if (settings.fixedStep > 0 && settings.maxStepsPerFrame < 1) {
+        std::cerr << "Max steps per frame should be at least 1, but was " << settings.maxStepsPerFrame << std::endl;
+        exit(-1);
+    }
+    if (settings.throughputMode && settings.fixedStep == 0) {
+        std::cerr << "Throughput mode requires a fixed step greater than 0." << std::endl;
+        exit(-1);
+    }
     if (settings.boidsLength <= 0 || settings.boidsWidth <= 0) {
         std::cerr << "Boids length and width can not be lower or equal to 0." << std::endl;
         std::cerr << "Boids length was " << settings.boidsLength << ", ";
@@ -114,6 +151,10 @@ void checkSettings(const Settings& settings) {
         std::cerr << "blue channel was " << settings.boidsColor.b << std::endl;
         exit(-1);
         }
+    if (settings.telemetryName.find('/') != std::string::npos) {
+        std::cerr << "Telemetry name should not contain '/', but was " << settings.telemetryName << std::endl;
+        exit(-1);
+    }
 #ifdef _OPENMP
     if (settings.threadsNumber < 1) {
         std::cerr << "Number of threads should be at least 1, but was " << settings.threadsNumber << std::endl;
@@ -129,6 +170,7 @@ void checkSettings(const Settings& settings) {
 Settings loadSettings(const std::string& path) {
     auto settings{ getSettings(path) };
     settings.boidsColor.a = SDL_ALPHA_OPAQUE_FLOAT;
+    if (settings.capacity == 0) settings.capacity = settings.population;
     checkSettings(settings);
     return settings;
 }
\ No newline at end of file
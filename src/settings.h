@@ -9,12 +9,17 @@
 // For more information about the settings refer to the README.
 struct Settings {
     size_t population{};
+    size_t capacity{};
+    size_t spawnBurst{ 10 };
     size_t screenWidth {};
     size_t screenHeight{};
     size_t maxRunNumber{};
     size_t threadsNumber{};
     size_t neighborLoopChunkSize{};
     bool disableVSync{};
+    float fixedStep{};
+    size_t maxStepsPerFrame{};
+    bool throughputMode{};
     float boidsLength{};
     float boidsWidth{};
     float minVelocity{}, maxVelocity{};
@@ -29,6 +34,7 @@ struct Settings {
     float dangerFactor{};
     size_t margin{};
     float turnSpeed{};
+    std::string telemetryName{};
 };
 
 // Load the settings from the file found at "path" and verify them.
@@ -10,13 +10,24 @@ Stats::Stats(std::string logFile)
 void Stats::startRun() {
     runNumber++;
     startTime = Clock::now();
+    if (runNumber == 1) {
+        firstStartTime = startTime;
+        reportStartTime = startTime;
+    }
 }
 
-void Stats::endRun() {
+void Stats::endRun(const size_t stepsNumber) {
     const auto endTime{ Clock::now() };
     runTimes.push_back(std::chrono::duration_cast<Duration>(endTime - startTime));
+    stepNumber += stepsNumber;
+    lastEndTime = endTime;
     if (runNumber % 1000 == 0) {
-        std::cout << "Reached " << runNumber << "th iteration" << std::endl;
+        const std::chrono::duration<double> reportTime{ endTime - reportStartTime };
+        std::cout << "Reached " << runNumber << "th iteration ("
+            << 1000 / reportTime.count() << " frames/s, "
+            << static_cast<double>(stepNumber - reportStepNumber) / reportTime.count() << " steps/s)" << std::endl;
+        reportStartTime = endTime;
+        reportStepNumber = stepNumber;
     }
 }
 
@@ -34,8 +45,10 @@ void Stats::log() const {
             return x + dif * dif.count();
         }) / runNumber
     };
+    const std::chrono::duration<double> totalTime{ lastEndTime - firstStartTime };
     log << std::format(
-        "Date:{0:%F},Time:{0:%R},Runs:{1},Max:{2},Min:{3},Mean:{4},Variance:{5}",
-        std::chrono::system_clock::now(), runNumber, *maxIt, *minIt, meanRunTime, varRunTime)
+        "Date:{0:%F},Time:{0:%R},Runs:{1},Steps:{2},Max:{3},Min:{4},Mean:{5},Variance:{6},FPS:{7:.2f},SPS:{8:.2f}",
+        std::chrono::system_clock::now(), runNumber, stepNumber, *maxIt, *minIt, meanRunTime, varRunTime,
+        runNumber / totalTime.count(), static_cast<double>(stepNumber) / totalTime.count())
         << std::endl;
 }
\ No newline at end of file
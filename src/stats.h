@@ -18,19 +18,24 @@ public:
     // Start registering time of run.
     // Should be called only once at the start of the run.
     void startRun();
-    // End registering time of run .
-    // Print a message every 1000 runs.
+    // End registering time of run in which "stepsNumber" simulation steps were run.
+    // Print a message with frames and steps per second every 1000 runs.
     // Should be called only once at the end of the run.
-    void endRun();
+    void endRun(size_t stepsNumber);
 
     // Write to "logFile" the stats of the runs:
-    // date, time, runs, max, min, mean, variance
+    // date, time, runs, steps, max, min, mean, variance, frames per second, steps per second
     void log() const;
 
 private:
     std::string logFile{};
     uint32_t runNumber{};
+    uint64_t stepNumber{};
     TimePoint startTime{};
+    TimePoint firstStartTime{};
+    TimePoint lastEndTime{};
+    TimePoint reportStartTime{};
+    uint64_t reportStepNumber{};
     std::vector<Duration> runTimes{};
 };
 
@@ -0,0 +1,180 @@
+#include "telemetry.h"
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BOIDS_POSIX_SHM
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Atomics shared between processes have to be address free
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free);
+
+#ifdef BOIDS_POSIX_SHM
+// Check if the process "pid" is running.
+bool isProcessAlive(const int32_t pid) {
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+// Check if "segmentName" is a telemetry segment whose writer is no longer running.
+//
+// Segments that are not telemetry segments are never considered stale.
+bool isSegmentStale(const std::string& segmentName) {
+    const int fd{ shm_open(segmentName.c_str(), O_RDONLY, 0) };
+    if (fd == -1) return false;
+    struct stat segmentStat{};
+    if (fstat(fd, &segmentStat) == -1 || static_cast<size_t>(segmentStat.st_size) < sizeof(TelemetryRing)) {
+        close(fd);
+        return false;
+    }
+    void* memory{ mmap(nullptr, sizeof(TelemetryRing), PROT_READ, MAP_SHARED, fd, 0) };
+    close(fd);
+    if (memory == MAP_FAILED) return false;
+    const auto* ring{ static_cast<const TelemetryRing*>(memory) };
+    const bool isStale{
+        ring->magicNumber == TelemetryRing::magic && ring->versionNumber == TelemetryRing::version &&
+        (ring->isClosed.load(std::memory_order_acquire) != 0 || !isProcessAlive(ring->writerPid))
+    };
+    munmap(memory, sizeof(TelemetryRing));
+    return isStale;
+}
+#endif
+
+TelemetryWriter::TelemetryWriter(const std::string& name)
+    : name{ "/" + name } {
+    if (name.empty()) return;
+#ifdef BOIDS_POSIX_SHM
+    int fd{ shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644) };
+    if (fd == -1 && errno == EEXIST && isSegmentStale(this->name)) {
+        shm_unlink(this->name.c_str());
+        fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd == -1 && errno == EEXIST) {
+        std::cerr << "Telemetry segment " << this->name << " is already in use" << std::endl;
+        std::cerr << "Choose another telemetry name or remove the segment if no simulation is using it" << std::endl;
+        exit(-1);
+    }
+    if (fd == -1) {
+        std::cerr << "Could not create telemetry segment " << this->name << ": " << std::strerror(errno) << std::endl;
+        exit(-1);
+    }
+    if (ftruncate(fd, sizeof(TelemetryRing)) == -1) {
+        std::cerr << "Could not resize telemetry segment " << this->name << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(this->name.c_str());
+        exit(-1);
+    }
+    void* memory{ mmap(nullptr, sizeof(TelemetryRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+    close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Could not map telemetry segment " << this->name << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(this->name.c_str());
+        exit(-1);
+    }
+    ring = new (memory) TelemetryRing{};
+    ring->writerPid = static_cast<int32_t>(getpid());
+    ring->versionNumber = TelemetryRing::version;
+    ring->magicNumber = TelemetryRing::magic;
+    std::atomic_thread_fence(std::memory_order_release);
+#else
+    std::cerr << "Telemetry requires POSIX shared memory, it will be disabled" << std::endl;
+#endif
+}
+
+TelemetryWriter::~TelemetryWriter() {
+#ifdef BOIDS_POSIX_SHM
+    if (!ring) return;
+    ring->isClosed.store(1, std::memory_order_release);
+    munmap(ring, sizeof(TelemetryRing));
+    shm_unlink(name.c_str());
+#endif
+}
+
+bool TelemetryWriter::isEnabled() const {
+    return ring != nullptr;
+}
+
+void TelemetryWriter::publish(const TelemetrySample& sample) {
+    if (!ring) return;
+    const auto n{ ring->writeCount.load(std::memory_order_relaxed) };
+    auto& slot{ ring->slots[n % TelemetryRing::capacity] };
+    slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sample = sample;
+    slot.sequence.store(2 * n + 2, std::memory_order_release);
+    ring->writeCount.store(n + 1, std::memory_order_release);
+}
+
+TelemetryReader::TelemetryReader(const std::string& name) {
+    const std::string segmentName{ "/" + name };
+#ifdef BOIDS_POSIX_SHM
+    const int fd{ shm_open(segmentName.c_str(), O_RDONLY, 0) };
+    if (fd == -1) {
+        std::cerr << "Could not open telemetry segment " << segmentName << ": " << std::strerror(errno) << std::endl;
+        exit(-1);
+    }
+    struct stat segmentStat{};
+    if (fstat(fd, &segmentStat) == -1 || static_cast<size_t>(segmentStat.st_size) < sizeof(TelemetryRing)) {
+        std::cerr << "Segment " << segmentName << " is not a telemetry segment" << std::endl;
+        close(fd);
+        exit(-1);
+    }
+    void* memory{ mmap(nullptr, sizeof(TelemetryRing), PROT_READ, MAP_SHARED, fd, 0) };
+    close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Could not map telemetry segment " << segmentName << ": " << std::strerror(errno) << std::endl;
+        exit(-1);
+    }
+    ring = static_cast<const TelemetryRing*>(memory);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (ring->magicNumber != TelemetryRing::magic || ring->versionNumber != TelemetryRing::version) {
+        std::cerr << "Segment " << segmentName << " is not a telemetry segment of version "
+            << TelemetryRing::version << std::endl;
+        exit(-1);
+    }
+#else
+    std::cerr << "Telemetry requires POSIX shared memory" << std::endl;
+    exit(-1);
+#endif
+}
+
+TelemetryReader::~TelemetryReader() {
+#ifdef BOIDS_POSIX_SHM
+    munmap(const_cast<TelemetryRing*>(ring), sizeof(TelemetryRing));
+#endif
+}
+
+uint64_t TelemetryReader::getWriteCount() const {
+    return ring->writeCount.load(std::memory_order_acquire);
+}
+
+bool TelemetryReader::isClosed() const {
+    return ring->isClosed.load(std::memory_order_acquire) != 0;
+}
+
+bool TelemetryReader::isWriterAlive() const {
+#ifdef BOIDS_POSIX_SHM
+    return !isClosed() && isProcessAlive(ring->writerPid);
+#else
+    return !isClosed();
+#endif
+}
+
+TelemetryReader::ReadResult TelemetryReader::read(const uint64_t n, TelemetrySample& sample) const {
+    const auto& slot{ ring->slots[n % TelemetryRing::capacity] };
+    const auto expectedSequence{ 2 * n + 2 };
+    const auto sequence{ slot.sequence.load(std::memory_order_acquire) };
+    if (sequence < expectedSequence) return ReadResult::NotReady;
+    if (sequence > expectedSequence) return ReadResult::Overwritten;
+    sample = slot.sample;
+    // The copy is valid only if the writer did not start changing the slot meanwhile
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expectedSequence) return ReadResult::Overwritten;
+    return ReadResult::Ok;
+}
\ No newline at end of file
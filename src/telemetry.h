@@ -0,0 +1,117 @@
+#ifndef BOIDS_TELEMETRY_H
+#define BOIDS_TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Metrics of a single frame.
+//
+// Times are expressed in microseconds.
+// Velocities and positions times are summed over all the steps of the frame.
+struct TelemetrySample {
+    uint64_t frame{};
+    uint64_t stepsNumber{};
+    uint64_t population{};
+    float frameTime{};
+    float eventsTime{};
+    float velocitiesTime{};
+    float positionsTime{};
+    float renderTime{};
+    uint64_t maxSquareOccupancy{};
+    float meanSquareOccupancy{};
+    uint64_t neighborCandidates{};
+};
+
+// Layout of the shared memory segment.
+//
+// It is a ring buffer with a single writer and any number of readers.
+// The sample number "n" is stored in the slot "n % capacity",
+// whose sequence is odd while the writer is changing it and "2n + 2" once sample "n" is complete.
+struct TelemetryRing {
+    static constexpr uint32_t magic{ 0x424F4944 };
+    static constexpr uint32_t version{ 2 };
+    static constexpr size_t capacity{ 1024 };
+
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        TelemetrySample sample;
+    };
+
+    uint32_t magicNumber;
+    uint32_t versionNumber;
+    int32_t writerPid;
+    std::atomic<uint32_t> isClosed;
+    std::atomic<uint64_t> writeCount;
+    Slot slots[capacity];
+};
+
+// Writer side of the telemetry channel.
+//
+// On systems without POSIX shared memory it is always disabled.
+class TelemetryWriter {
+public:
+    // Create the shared memory segment "/name".
+    //
+    // If "name" is empty the writer is disabled.
+    // A segment left behind by a writer that is no longer running is replaced.
+    // If the segment is used by a running writer or can not be created print an error string and exit the program.
+    explicit TelemetryWriter(const std::string& name);
+    // Mark the channel as closed and remove the segment.
+    ~TelemetryWriter();
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    [[nodiscard]]
+    bool isEnabled() const;
+
+    // Publish "sample" without ever blocking.
+    //
+    // Should be called only by one thread.
+    void publish(const TelemetrySample& sample);
+
+private:
+    std::string name{};
+    TelemetryRing* ring{};
+};
+
+// Reader side of the telemetry channel.
+class TelemetryReader {
+public:
+    enum class ReadResult {
+        Ok,
+        NotReady,
+        Overwritten
+    };
+
+    // Attach to the shared memory segment "/name".
+    //
+    // If the segment can not be opened or is not a telemetry channel print an error string and exit the program.
+    explicit TelemetryReader(const std::string& name);
+    ~TelemetryReader();
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    // Return the number of samples published so far.
+    [[nodiscard]]
+    uint64_t getWriteCount() const;
+    // Return whether the writer has closed the channel.
+    [[nodiscard]]
+    bool isClosed() const;
+    // Return whether the writer has not closed the channel and its process is still running.
+    //
+    // It detects writers that were killed or crashed without closing the channel.
+    [[nodiscard]]
+    bool isWriterAlive() const;
+
+    // Copy into "sample" the sample number "n".
+    //
+    // Return "NotReady" if it was not published yet,
+    // "Overwritten" if the writer has already reused its slot.
+    ReadResult read(uint64_t n, TelemetrySample& sample) const;
+
+private:
+    const TelemetryRing* ring{};
+};
+
+#endif //BOIDS_TELEMETRY_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "telemetry.h"
+
+// Metrics aggregated over consecutive frames.
+struct Aggregate {
+    // Add "sample" to the aggregate.
+    void add(const TelemetrySample& sample);
+    // Print the aggregate to the standard output.
+    void print() const;
+
+    uint64_t framesNumber{};
+    uint64_t lastFrame{};
+    uint64_t stepsNumber{};
+    uint64_t population{};
+    float frameTime{};
+    float maxFrameTime{};
+    float eventsTime{};
+    float velocitiesTime{};
+    float positionsTime{};
+    float renderTime{};
+    uint64_t maxSquareOccupancy{};
+    float maxOccupancySkew{};
+    uint64_t neighborCandidates{};
+};
+
+void Aggregate::add(const TelemetrySample& sample) {
+    framesNumber++;
+    lastFrame = sample.frame;
+    stepsNumber += sample.stepsNumber;
+    population = sample.population;
+    frameTime += sample.frameTime;
+    maxFrameTime = std::max(maxFrameTime, sample.frameTime);
+    eventsTime += sample.eventsTime;
+    velocitiesTime += sample.velocitiesTime;
+    positionsTime += sample.positionsTime;
+    renderTime += sample.renderTime;
+    maxSquareOccupancy = std::max(maxSquareOccupancy, sample.maxSquareOccupancy);
+    if (sample.meanSquareOccupancy > 0) {
+        maxOccupancySkew = std::max(maxOccupancySkew,
+            static_cast<float>(sample.maxSquareOccupancy) / sample.meanSquareOccupancy);
+    }
+    neighborCandidates += sample.neighborCandidates;
+}
+
+void Aggregate::print() const {
+    const auto frames{ static_cast<float>(framesNumber) };
+    const auto steps{ static_cast<float>(std::max<uint64_t>(stepsNumber, 1)) };
+    std::cout << std::format(
+        "Frame:{},Frames:{},Steps:{},Population:{},FrameTime:{:.1f},MaxFrameTime:{:.1f},StepTime:{:.1f},"
+        "Events:{:.1f},Velocities:{:.1f},Positions:{:.1f},Render:{:.1f},MaxOccupancy:{},Skew:{:.2f},Candidates:{:.0f}",
+        lastFrame, framesNumber, stepsNumber, population, frameTime / frames, maxFrameTime,
+        (velocitiesTime + positionsTime) / steps, eventsTime / frames, velocitiesTime / frames,
+        positionsTime / frames, renderTime / frames, maxSquareOccupancy, maxOccupancySkew,
+        static_cast<float>(neighborCandidates) / steps)
+        << std::endl;
+}
+
+// Print the usage message of the program "program".
+void printUsage(const std::string& program) {
+    std::cerr << "Usage: " << program << " <name> [frames]" << std::endl;
+    std::cerr << "Print the metrics of the simulation publishing on \"name\", "
+        "aggregating them every \"frames\" frames (1 by default)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return -1;
+    }
+    size_t aggregatedFrames{ 1 };
+    if (argc > 2) {
+        try {
+            aggregatedFrames = std::stoul(argv[2]);
+        } catch (const std::logic_error&) {
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+    if (aggregatedFrames < 1) {
+        std::cerr << "Frames should be at least 1, but was " << aggregatedFrames << std::endl;
+        return -1;
+    }
+
+    const TelemetryReader reader{ argv[1] };
+    auto nextSample{ reader.getWriteCount() };
+    Aggregate aggregate{};
+    while (true) {
+        TelemetrySample sample;
+        switch (reader.read(nextSample, sample)) {
+            case TelemetryReader::ReadResult::Ok: {
+                nextSample++;
+                aggregate.add(sample);
+                if (aggregate.framesNumber == aggregatedFrames) {
+                    aggregate.print();
+                    aggregate = {};
+                }
+                break;
+            }
+            case TelemetryReader::ReadResult::NotReady: {
+                if (!reader.isWriterAlive() && reader.getWriteCount() == nextSample) {
+                    if (aggregate.framesNumber > 0) aggregate.print();
+                    if (!reader.isClosed()) std::cerr << "Simulation stopped without closing the channel" << std::endl;
+                    return 0;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+                break;
+            }
+            case TelemetryReader::ReadResult::Overwritten: {
+                const auto writeCount{ reader.getWriteCount() };
+                std::cerr << "Skipped " << writeCount - nextSample << " frames" << std::endl;
+                nextSample = writeCount;
+                break;
+            }
+        }
+    }
+}
\ No newline at end of file